@@ -1,7 +1,33 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L     // mkdir, rmdir, getpid, nanosleep
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#include <process.h>
+#define makeDir(path) _mkdir(path)
+#define removeDir(path) _rmdir(path)
+#define processId() _getpid()
+#define sleepMs(ms) Sleep(ms)
+#else
+#include <unistd.h>
+#define makeDir(path) mkdir(path, 0755)
+#define removeDir(path) rmdir(path)
+#define processId() getpid()
+static inline void sleepMs(long ms) {
+    struct timespec ts = { ms / 1000, (ms % 1000) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+#endif
 
 #define MAX_LINE 1024
 #define MAX_NAME 100
@@ -10,6 +36,7 @@
 #define MAX_PERIODS 8
 #define MAX_FACULTY 50
 #define MAX_SUBJECTS 100
+#define MAX_ROW_LINE (MAX_PERIODS * (2 * MAX_NAME + 16) + MAX_LINE)
 
 // Structures
 typedef struct {
@@ -74,6 +101,20 @@ int getSectionIndex(char* section) {
     return -1;
 }
 
+int getSubjectIndex(int subjectId) {
+    for (int i = 0; i < subjectCount; i++) {
+        if (subjects[i].id == subjectId) return i;
+    }
+    return -1;
+}
+
+int getFacultyIndex(int facultyId) {
+    for (int i = 0; i < facultyCount; i++) {
+        if (faculties[i].id == facultyId) return i;
+    }
+    return -1;
+}
+
 // CHANGED: New function to get faculty ID for a specific subject and section
 int getFacultyForSection(int subjectId, char* section) {
     for (int i = 0; i < subjectCount; i++) {
@@ -328,39 +369,229 @@ int countClassesInDay(int day, int sectionIdx) {
     return count;
 }
 
-// CHANGED: Updated to use section-specific faculty
-bool findAndAssignLabSlot(int subjectId, char* section, int* assignedDay, int* assignedPeriod) {
-    int sectionIdx = getSectionIndex(section);
-    if (sectionIdx == -1) return false;
+// ============================================================================
+// Week Kernels
+// When a whole week fits in one 64-bit word, occupancy is kept as bitboards
+// (one lane of P bits per day) and slot search becomes a few word operations.
+// Kernels are instantiated per grid shape so the day loop and lane masks are
+// compile-time constants; selectWeekKernel() picks one at runtime or falls
+// back to the generic loops above. Build with -DNO_WEEK_KERNELS to force the
+// generic path.
+// ============================================================================
+typedef unsigned long long WeekMask;
+
+typedef struct {
+    int days;
+    int periods;
+    bool (*findTheorySlot)(int sectionIdx, int facIdx, int subIdx, int* day, int* period);
+    bool (*findLabSlot)(int sectionIdx, int facIdx, int* day, int* period);
+} WeekKernel;
+
+WeekMask sectionWeek[MAX_SECTIONS];                 // Occupied periods
+WeekMask sectionLabWeek[MAX_SECTIONS];              // Periods holding a lab subject
+WeekMask facultyWeek[MAX_FACULTY];                  // By faculty index
+WeekMask subjectWeek[MAX_SUBJECTS][MAX_SECTIONS];   // By subject index, section index
+WeekMask weekValid;                                 // Periods that exist in slots.csv
+int weekLaneWidth = 0;                              // 0 = bitboards not in use
+const WeekKernel* activeKernel = NULL;
+
+static inline int weekPopcount(WeekMask m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(m);
+#else
+    int count = 0;
+    while (m) { m &= m - 1; count++; }
+    return count;
+#endif
+}
+
+static inline int weekLowestBit(WeekMask m) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(m);
+#else
+    int bit = 0;
+    while (!(m & 1)) { m >>= 1; bit++; }
+    return bit;
+#endif
+}
+
+static inline WeekMask laneMask(int P) {
+    return (1ULL << P) - 1;
+}
+
+static inline WeekMask laneFirstBits(int D, int P) {
+    WeekMask m = 0;
+    for (int d = 0; d < D; d++) m |= 1ULL << (d * P);
+    return m;
+}
+
+// Periods directly before or after a set bit, without crossing into another day
+static inline WeekMask adjacentPeriods(WeekMask m, int D, int P) {
+    WeekMask first = laneFirstBits(D, P);
+    WeekMask last = first << (P - 1);
+    return ((m << 1) & ~first) | ((m >> 1) & ~last);
+}
+
+// Same choice as the generic loops: least loaded day with a candidate, ties
+// going to the earlier day, then the earliest candidate period in that day.
+static inline bool pickLeastLoadedDay(WeekMask candidates, WeekMask occupied, WeekMask excludedDays,
+                                      int D, int P, int* day, int* period) {
+    int bestDay = -1, minLoad = 9999;
+    for (int d = 0; d < D; d++) {
+        WeekMask lane = (candidates >> (d * P)) & laneMask(P);
+        int load = weekPopcount((occupied >> (d * P)) & laneMask(P));
+        bool better = lane != 0 && !((excludedDays >> d) & 1) && load < minLoad;
+        minLoad = better ? load : minLoad;
+        bestDay = better ? d : bestDay;
+    }
+    if (bestDay == -1) return false;
     
-    int subIdx = -1;
-    for (int i = 0; i < subjectCount; i++) {
-        if (subjects[i].id == subjectId) { subIdx = i; break; }
+    *day = bestDay;
+    *period = weekLowestBit((candidates >> (bestDay * P)) & laneMask(P));
+    return true;
+}
+
+static inline bool findTheorySlotKernel(int sectionIdx, int facIdx, int subIdx, int D, int P,
+                                        int* day, int* period) {
+    WeekMask blocked = sectionWeek[sectionIdx] | facultyWeek[facIdx] |
+                       adjacentPeriods(subjectWeek[subIdx][sectionIdx], D, P);
+    return pickLeastLoadedDay(weekValid & ~blocked, sectionWeek[sectionIdx], 0, D, P, day, period);
+}
+
+static inline bool findLabSlotKernel(int sectionIdx, int facIdx, int D, int P, int* day, int* period) {
+    WeekMask free = weekValid & ~(sectionWeek[sectionIdx] | facultyWeek[facIdx]);
+    WeekMask last = laneFirstBits(D, P) << (P - 1);
+    WeekMask starts = free & (free >> 1) & ~last;
+    
+    // One lab per day: drop every day that already holds a lab subject
+    WeekMask labDays = 0;
+    for (int d = 0; d < D; d++) {
+        labDays |= (WeekMask)(((sectionLabWeek[sectionIdx] >> (d * P)) & laneMask(P)) != 0) << d;
+    }
+    return pickLeastLoadedDay(starts, sectionWeek[sectionIdx], labDays, D, P, day, period);
+}
+
+#define DEFINE_WEEK_KERNEL(D, P) \
+    static bool findTheorySlot_##D##x##P(int sectionIdx, int facIdx, int subIdx, int* day, int* period) { \
+        return findTheorySlotKernel(sectionIdx, facIdx, subIdx, D, P, day, period); \
+    } \
+    static bool findLabSlot_##D##x##P(int sectionIdx, int facIdx, int* day, int* period) { \
+        return findLabSlotKernel(sectionIdx, facIdx, D, P, day, period); \
+    }
+
+#define WEEK_KERNEL(D, P) { D, P, findTheorySlot_##D##x##P, findLabSlot_##D##x##P }
+
+DEFINE_WEEK_KERNEL(5, 8)
+DEFINE_WEEK_KERNEL(6, 8)
+
+// Smallest shapes first so the tightest fit wins
+const WeekKernel weekKernels[] = {
+    WEEK_KERNEL(5, 8),
+    WEEK_KERNEL(6, 8),
+};
+
+void markWeekBoards(int day, int period, int sectionIdx, int facIdx, int subIdx) {
+    if (weekLaneWidth == 0) return;
+    
+    WeekMask bit = 1ULL << (day * weekLaneWidth + period);
+    sectionWeek[sectionIdx] |= bit;
+    facultyWeek[facIdx] |= bit;
+    subjectWeek[subIdx][sectionIdx] |= bit;
+    if (subjects[subIdx].isLab) sectionLabWeek[sectionIdx] |= bit;
+}
+
+void clearWeekBoards() {
+    memset(sectionWeek, 0, sizeof(sectionWeek));
+    memset(sectionLabWeek, 0, sizeof(sectionLabWeek));
+    memset(facultyWeek, 0, sizeof(facultyWeek));
+    memset(subjectWeek, 0, sizeof(subjectWeek));
+}
+
+// Picks the kernel for the loaded slots and rebuilds the bitboards from the
+// current timetable in that kernel's layout.
+void selectWeekKernel() {
+    int maxPeriods = 0;
+    for (int d = 0; d < dayCount; d++) {
+        if (days[d].periods > maxPeriods) maxPeriods = days[d].periods;
     }
-    if (subIdx == -1) return false;
     
-    // CHANGED: Get faculty ID for this specific section
-    int facultyId = getFacultyForSection(subjectId, section);
-    if (facultyId == -1) {
-        printf("Error: No faculty assigned for subject %d, section %s\n", subjectId, section);
-        return false;
+    activeKernel = NULL;
+    weekLaneWidth = 0;
+#ifndef NO_WEEK_KERNELS
+    // Kernels never index past the grid, which only holds MAX_DAYS x MAX_PERIODS
+    bool fitsGrid = dayCount <= MAX_DAYS && maxPeriods <= MAX_PERIODS;
+    for (size_t k = 0; fitsGrid && k < sizeof(weekKernels) / sizeof(weekKernels[0]); k++) {
+        if (dayCount <= weekKernels[k].days && maxPeriods <= weekKernels[k].periods) {
+            activeKernel = &weekKernels[k];
+            weekLaneWidth = activeKernel->periods;
+            break;
+        }
     }
+#endif
     
-    int facIdx = -1;
-    for (int i = 0; i < facultyCount; i++) {
-        if (faculties[i].id == facultyId) { facIdx = i; break; }
+    clearWeekBoards();
+    if (activeKernel == NULL) {
+        printf("Slot search: generic (%d days x %d periods)\n", dayCount, maxPeriods);
+        return;
     }
-    if (facIdx == -1) return false;
     
-    int bestDay = -1, bestPeriod = -1, minLoad = 9999;
+    weekValid = 0;
+    for (int d = 0; d < dayCount; d++) {
+        weekValid |= laneMask(days[d].periods) << (d * weekLaneWidth);
+    }
     for (int d = 0; d < dayCount; d++) {
-        int dayLoad = countClassesInDay(d, sectionIdx);
-        for (int p = 0; p < days[d].periods - 1; p++) {
-            if (canAssignLab(facultyId, d, p, sectionIdx)) {
-                if (dayLoad < minLoad) {
-                    minLoad = dayLoad;
-                    bestDay = d;
-                    bestPeriod = p;
+        for (int p = 0; p < days[d].periods; p++) {
+            for (int s = 0; s < branch.sectionCount; s++) {
+                int facIdx = getFacultyIndex(timetable[d][p][s].facultyId);
+                int subIdx = getSubjectIndex(timetable[d][p][s].subjectId);
+                if (facIdx == -1 || subIdx == -1) continue;
+                markWeekBoards(d, p, s, facIdx, subIdx);
+            }
+        }
+    }
+    printf("Slot search: %dx%d week kernel\n", activeKernel->days, activeKernel->periods);
+}
+
+void clearTimetable() {
+    for (int d = 0; d < MAX_DAYS; d++) {
+        for (int p = 0; p < MAX_PERIODS; p++) {
+            for (int s = 0; s < MAX_SECTIONS; s++) {
+                timetable[d][p][s].facultyId = -1;
+                timetable[d][p][s].subjectId = -1;
+                strcpy(timetable[d][p][s].section, "");
+            }
+        }
+    }
+    clearWeekBoards();
+}
+
+// Takes faculty and subject indices, not ids
+void placeSlot(int day, int period, int sectionIdx, int facIdx, int subIdx) {
+    timetable[day][period][sectionIdx].facultyId = faculties[facIdx].id;
+    timetable[day][period][sectionIdx].subjectId = subjects[subIdx].id;
+    strcpy(timetable[day][period][sectionIdx].section, branch.sections[sectionIdx]);
+    markWeekBoards(day, period, sectionIdx, facIdx, subIdx);
+}
+
+// CHANGED: Updated to use section-specific faculty
+// Indices are resolved once per subject/section by generateTimetable
+bool findAndAssignLabSlot(int subIdx, int sectionIdx, int facIdx, int* assignedDay, int* assignedPeriod) {
+    int facultyId = faculties[facIdx].id;
+    
+    int bestDay = -1, bestPeriod = -1, minLoad = 9999;
+    if (activeKernel != NULL) {
+        if (faculties[facIdx].assignedHours + 2 > faculties[facIdx].maxHours) return false;
+        activeKernel->findLabSlot(sectionIdx, facIdx, &bestDay, &bestPeriod);
+    } else {
+        for (int d = 0; d < dayCount; d++) {
+            int dayLoad = countClassesInDay(d, sectionIdx);
+            for (int p = 0; p < days[d].periods - 1; p++) {
+                if (canAssignLab(facultyId, d, p, sectionIdx)) {
+                    if (dayLoad < minLoad) {
+                        minLoad = dayLoad;
+                        bestDay = d;
+                        bestPeriod = p;
+                    }
                 }
             }
         }
@@ -368,13 +599,8 @@ bool findAndAssignLabSlot(int subjectId, char* section, int* assignedDay, int* a
     
     if (bestDay == -1) return false;
     
-    timetable[bestDay][bestPeriod][sectionIdx].facultyId = facultyId;
-    timetable[bestDay][bestPeriod][sectionIdx].subjectId = subjects[subIdx].id;
-    strcpy(timetable[bestDay][bestPeriod][sectionIdx].section, section);
-    
-    timetable[bestDay][bestPeriod + 1][sectionIdx].facultyId = facultyId;
-    timetable[bestDay][bestPeriod + 1][sectionIdx].subjectId = subjects[subIdx].id;
-    strcpy(timetable[bestDay][bestPeriod + 1][sectionIdx].section, section);
+    placeSlot(bestDay, bestPeriod, sectionIdx, facIdx, subIdx);
+    placeSlot(bestDay, bestPeriod + 1, sectionIdx, facIdx, subIdx);
     
     faculties[facIdx].assignedHours += 2;
     
@@ -384,39 +610,24 @@ bool findAndAssignLabSlot(int subjectId, char* section, int* assignedDay, int* a
 }
 
 // CHANGED: Updated to use section-specific faculty
-bool findAndAssignSlot(int subjectId, char* section, int* assignedDay, int* assignedPeriod) {
-    int sectionIdx = getSectionIndex(section);
-    if (sectionIdx == -1) return false;
-    
-    int subIdx = -1;
-    for (int i = 0; i < subjectCount; i++) {
-        if (subjects[i].id == subjectId) { subIdx = i; break; }
-    }
-    if (subIdx == -1) return false;
-    
-    // CHANGED: Get faculty ID for this specific section
-    int facultyId = getFacultyForSection(subjectId, section);
-    if (facultyId == -1) {
-        printf("Error: No faculty assigned for subject %d, section %s\n", subjectId, section);
-        return false;
-    }
-    
-    int facIdx = -1;
-    for (int i = 0; i < facultyCount; i++) {
-        if (faculties[i].id == facultyId) { facIdx = i; break; }
-    }
-    if (facIdx == -1) return false;
+bool findAndAssignSlot(int subIdx, int sectionIdx, int facIdx, int* assignedDay, int* assignedPeriod) {
+    int facultyId = faculties[facIdx].id;
     
     int bestDay = -1, bestPeriod = -1, minLoad = 9999;
-    for (int d = 0; d < dayCount; d++) {
-        int dayLoad = countClassesInDay(d, sectionIdx);
-        
-        for (int p = 0; p < days[d].periods; p++) {
-            if (canAssign(facultyId, subjects[subIdx].id, d, p, sectionIdx)) {
-                if (dayLoad < minLoad) {
-                    minLoad = dayLoad;
-                    bestDay = d;
-                    bestPeriod = p;
+    if (activeKernel != NULL) {
+        if (faculties[facIdx].assignedHours >= faculties[facIdx].maxHours) return false;
+        activeKernel->findTheorySlot(sectionIdx, facIdx, subIdx, &bestDay, &bestPeriod);
+    } else {
+        for (int d = 0; d < dayCount; d++) {
+            int dayLoad = countClassesInDay(d, sectionIdx);
+            
+            for (int p = 0; p < days[d].periods; p++) {
+                if (canAssign(facultyId, subjects[subIdx].id, d, p, sectionIdx)) {
+                    if (dayLoad < minLoad) {
+                        minLoad = dayLoad;
+                        bestDay = d;
+                        bestPeriod = p;
+                    }
                 }
             }
         }
@@ -424,9 +635,7 @@ bool findAndAssignSlot(int subjectId, char* section, int* assignedDay, int* assi
     
     if (bestDay == -1) return false;
     
-    timetable[bestDay][bestPeriod][sectionIdx].facultyId = facultyId;
-    timetable[bestDay][bestPeriod][sectionIdx].subjectId = subjects[subIdx].id;
-    strcpy(timetable[bestDay][bestPeriod][sectionIdx].section, section);
+    placeSlot(bestDay, bestPeriod, sectionIdx, facIdx, subIdx);
     
     faculties[facIdx].assignedHours++;
     
@@ -435,47 +644,108 @@ bool findAndAssignSlot(int subjectId, char* section, int* assignedDay, int* assi
     return true;
 }
 
-void generateTimetable() {
+// Warm start: pre-places the cells of an earlier solution that are still valid
+// for the current model. Cells are checked with the same constraints as a cold
+// solve. generateTimetable seeds lab blocks first, then runs phase 1 for the
+// remaining labs, and only then seeds theory cells, so seeded theory can never
+// take a gap a lab needs. A seeded lab run is only ever re-placed as a whole.
+// Returns the number of periods seeded.
+int seedTimetable(TimeSlot seed[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS], bool labPass,
+                  int remainingHours[MAX_SUBJECTS][MAX_SECTIONS], bool labPlaced[MAX_SUBJECTS][MAX_SECTIONS]) {
+    int seeded = 0;
+    
     for (int d = 0; d < dayCount; d++) {
-        for (int p = 0; p < days[d].periods; p++) {
-            for (int s = 0; s < branch.sectionCount; s++) {
-                timetable[d][p][s].facultyId = -1;
-                timetable[d][p][s].subjectId = -1;
-                strcpy(timetable[d][p][s].section, "");
+        for (int s = 0; s < branch.sectionCount; s++) {
+            int p = 0;
+            while (p < days[d].periods) {
+                int subjectId = seed[d][p][s].subjectId;
+                int facultyId = seed[d][p][s].facultyId;
+                int runEnd = p + 1;
+                while (runEnd < days[d].periods && seed[d][runEnd][s].subjectId == subjectId &&
+                       seed[d][runEnd][s].facultyId == facultyId) runEnd++;
+                
+                int subIdx = getSubjectIndex(subjectId);
+                int facIdx = getFacultyIndex(facultyId);
+                if (subjectId == -1 || subIdx == -1 || facIdx == -1 ||
+                    getFacultyForSection(subjectId, branch.sections[s]) != facultyId) {
+                    p = runEnd;
+                    continue;
+                }
+                
+                int j = 0;
+                while (strcmp(subjects[subIdx].sections[j], branch.sections[s]) != 0) j++;
+                bool labRun = runEnd - p == 2 && subjects[subIdx].isLab;
+                
+                if (labPass) {
+                    if (labRun && !labPlaced[subIdx][j] && remainingHours[subIdx][j] >= 2 &&
+                        canAssignLab(facultyId, d, p, s)) {
+                        placeSlot(d, p, s, facIdx, subIdx);
+                        placeSlot(d, p + 1, s, facIdx, subIdx);
+                        faculties[facIdx].assignedHours += 2;
+                        remainingHours[subIdx][j] -= 2;
+                        labPlaced[subIdx][j] = true;
+                        seeded += 2;
+                    }
+                } else if (!labRun) {
+                    for (int q = p; q < runEnd; q++) {
+                        if (remainingHours[subIdx][j] > 0 && canAssign(facultyId, subjectId, d, q, s)) {
+                            placeSlot(d, q, s, facIdx, subIdx);
+                            faculties[facIdx].assignedHours++;
+                            remainingHours[subIdx][j]--;
+                            seeded++;
+                        }
+                    }
+                }
+                p = runEnd;
             }
         }
     }
+    return seeded;
+}
+
+// seed may be NULL for a cold solve
+void generateTimetable(TimeSlot seed[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS]) {
+    clearTimetable();
+    selectWeekKernel();
+    for (int f = 0; f < facultyCount; f++) faculties[f].assignedHours = 0;
     
     // UPDATED: Track remaining hours for each subject per section
     // Format: remainingHours[subjectIndex][sectionIndex]
     int remainingHours[MAX_SUBJECTS][MAX_SECTIONS];
+    bool labPlaced[MAX_SUBJECTS][MAX_SECTIONS];
+    int sectionOf[MAX_SUBJECTS][MAX_SECTIONS];     // Branch section index, -1 if unknown
+    int facultyOf[MAX_SUBJECTS][MAX_SECTIONS];     // Faculty index, -1 if unknown
     for (int i = 0; i < subjectCount; i++) {
         for (int j = 0; j < subjects[i].sectionCount; j++) {
             remainingHours[i][j] = subjects[i].hoursPerWeek;
+            labPlaced[i][j] = false;
+            sectionOf[i][j] = getSectionIndex(subjects[i].sections[j]);
+            facultyOf[i][j] = getFacultyIndex(getFacultyForSection(subjects[i].id, subjects[i].sections[j]));
         }
     }
     
+    int seededPeriods = 0;
+    if (seed != NULL) {
+        seededPeriods = seedTimetable(seed, true, remainingHours, labPlaced);
+        printf("\n=== Warm Start: %d lab blocks seeded from closest cached solution ===\n", seededPeriods / 2);
+    }
+    
     printf("\n=== PHASE 1: Assigning Labs (Deducted from total hours) ===\n");
     int labsAssigned = 0;
     
     for (int i = 0; i < subjectCount; i++) {
         if (subjects[i].isLab) {
             for (int j = 0; j < subjects[i].sectionCount; j++) {
+                if (labPlaced[i][j]) continue;
                 int assignedDay = -1, assignedPeriod = -1;
-                if (findAndAssignLabSlot(subjects[i].id, subjects[i].sections[j], &assignedDay, &assignedPeriod)) {
+                if (sectionOf[i][j] != -1 && facultyOf[i][j] != -1 &&
+                    findAndAssignLabSlot(i, sectionOf[i][j], facultyOf[i][j], &assignedDay, &assignedPeriod)) {
                     labsAssigned++;
                     
                     // UPDATED: Deduct 2 hours (lab) from total hoursPerWeek
                     remainingHours[i][j] -= 2;
                     
-                    int facultyId = getFacultyForSection(subjects[i].id, subjects[i].sections[j]);
-                    char* facultyName = "Unknown";
-                    for (int f = 0; f < facultyCount; f++) {
-                        if (faculties[f].id == facultyId) {
-                            facultyName = faculties[f].name;
-                            break;
-                        }
-                    }
+                    char* facultyName = faculties[facultyOf[i][j]].name;
                     printf("✓ LAB %d: %s - Section %s (Faculty: %s): Day %d, Periods %d-%d | Remaining theory hours: %d\n",
                            labsAssigned, subjects[i].name, subjects[i].sections[j], 
                            facultyName, assignedDay+1, assignedPeriod+1, assignedPeriod+2, remainingHours[i][j]);
@@ -486,6 +756,12 @@ void generateTimetable() {
         }
     }
     
+    if (seed != NULL) {
+        int seededTheory = seedTimetable(seed, false, remainingHours, labPlaced);
+        seededPeriods += seededTheory;
+        printf("\n=== Warm Start: %d theory periods seeded from closest cached solution ===\n", seededTheory);
+    }
+    
     printf("\n=== PHASE 2: Assigning Theory Classes (Remaining hours after lab deduction) ===\n");
     int theoryAssigned = 0;
     
@@ -497,17 +773,11 @@ void generateTimetable() {
             if (theoryHoursToAssign > 0) {
                 for (int h = 0; h < theoryHoursToAssign; h++) {
                     int assignedDay = -1, assignedPeriod = -1;
-                    if (findAndAssignSlot(subjects[i].id, subjects[i].sections[j], &assignedDay, &assignedPeriod)) {
+                    if (sectionOf[i][j] != -1 && facultyOf[i][j] != -1 &&
+                        findAndAssignSlot(i, sectionOf[i][j], facultyOf[i][j], &assignedDay, &assignedPeriod)) {
                         theoryAssigned++;
                         if (theoryAssigned <= 20 || theoryAssigned % 10 == 0) {
-                            int facultyId = getFacultyForSection(subjects[i].id, subjects[i].sections[j]);
-                            char* facultyName = "Unknown";
-                            for (int f = 0; f < facultyCount; f++) {
-                                if (faculties[f].id == facultyId) {
-                                    facultyName = faculties[f].name;
-                                    break;
-                                }
-                            }
+                            char* facultyName = faculties[facultyOf[i][j]].name;
                             printf("✓ Theory %d: %s - Section %s (Faculty: %s): Day %d, Period %d (hour %d/%d)\n",
                                    theoryAssigned, subjects[i].name, subjects[i].sections[j], 
                                    facultyName, assignedDay+1, assignedPeriod+1, h+1, theoryHoursToAssign);
@@ -524,7 +794,8 @@ void generateTimetable() {
     printf("\n=== Summary ===\n");
     printf("Labs assigned: %d (each lab = 2 periods)\n", labsAssigned);
     printf("Theory assigned: %d\n", theoryAssigned);
-    printf("Total periods used: %d\n", (labsAssigned * 2) + theoryAssigned);
+    if (seed != NULL) printf("Seeded from cache: %d periods\n", seededPeriods);
+    printf("Total periods used: %d\n", (labsAssigned * 2) + theoryAssigned + seededPeriods);
     
     printf("\n=== Constraint Validation ===\n");
     for (int s = 0; s < branch.sectionCount; s++) {
@@ -728,16 +999,1226 @@ void generateSummary() {
     printf("Generated summary.csv\n");
 }
 
-int main() {
-    printf("=== Timetable Generator with Section-Specific Faculty Assignment ===\n\n");
+// ============================================================================
+// Result Cache
+// Solutions are stored in CACHE_DIR under a hash of the normalized model and
+// solver settings. A hit restores the grid without solving; otherwise the
+// cached solution sharing the most still-valid placements seeds the solve.
+// index.csv holds Key,LastUsed for LRU eviction and is only rewritten while
+// holding the lock directory; entry and index files are written to a temp
+// file and renamed into place so readers never see a partial file.
+// ============================================================================
+#define CACHE_DIR "classsync_cache"
+#define CACHE_LOCK CACHE_DIR "/lock"
+#define CACHE_BREAK_LOCK CACHE_DIR "/lock.break"
+#define CACHE_INDEX CACHE_DIR "/index.csv"
+#define CACHE_MAX_ENTRIES 64
+#define CACHE_KEY_LEN 17
+#define CACHE_LOCK_RETRIES 200
+#define CACHE_LOCK_STALE_SECONDS 30
+#define SOLVER_VERSION 1    // Bump whenever placement rules change so old entries miss
+
+typedef unsigned long long Hash64;
+
+typedef struct {
+    char key[CACHE_KEY_LEN];
+    long lastUsed;
+} CacheEntry;
+
+TimeSlot cachedGrid[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS];
+TimeSlot closestGrid[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS];
+
+// FNV-1a. Numbers are hashed as text so keys match across platforms.
+Hash64 hashText(Hash64 h, const char* text) {
+    while (*text) {
+        h ^= (unsigned char)*text++;
+        h *= 1099511628211ULL;
+    }
+    h ^= ';';
+    h *= 1099511628211ULL;
+    return h;
+}
+
+Hash64 hashInt(Hash64 h, int value) {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%d", value);
+    return hashText(h, buf);
+}
+
+// Names are left out: they only affect output text, which is always
+// regenerated from the current model.
+void computeModelKey(char key[CACHE_KEY_LEN]) {
+    Hash64 h = 1469598103934665603ULL;
     
-    readFacultyCSV("faculty.csv");
-    readSubjectsCSV("subjects.csv");
-    readSectionsCSV("sections.csv");
-    readSlotsCSV("slots.csv");
+    h = hashInt(h, SOLVER_VERSION);
+    h = hashInt(h, facultyCount);
+    for (int i = 0; i < facultyCount; i++) {
+        h = hashInt(h, faculties[i].id);
+        h = hashInt(h, faculties[i].maxHours);
+    }
+    h = hashInt(h, subjectCount);
+    for (int i = 0; i < subjectCount; i++) {
+        h = hashInt(h, subjects[i].id);
+        h = hashInt(h, subjects[i].hoursPerWeek);
+        h = hashInt(h, subjects[i].isLab);
+        h = hashInt(h, subjects[i].sectionCount);
+        for (int j = 0; j < subjects[i].sectionCount; j++) {
+            h = hashText(h, subjects[i].sections[j]);
+            h = hashInt(h, subjects[i].facultyIds[j]);
+        }
+    }
+    h = hashInt(h, branch.sectionCount);
+    for (int s = 0; s < branch.sectionCount; s++) {
+        h = hashText(h, branch.sections[s]);
+    }
+    h = hashInt(h, dayCount);
+    for (int d = 0; d < dayCount; d++) {
+        h = hashInt(h, days[d].periods);
+    }
     
-    printf("\n=== Generating Timetable ===\n");
-    generateTimetable();
+    snprintf(key, CACHE_KEY_LEN, "%016llx", h);
+}
+
+void cacheEntryPath(char* path, size_t size, const char* key) {
+    snprintf(path, size, "%s/%s.csv", CACHE_DIR, key);
+}
+
+// Atomically replaces dst with src
+bool replaceFile(const char* src, const char* dst) {
+#ifdef _WIN32
+    return MoveFileExA(src, dst, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return rename(src, dst) == 0;
+#endif
+}
+
+bool isStaleLock(const char* path) {
+    struct stat st;
+    return stat(path, &st) == 0 && time(NULL) - st.st_mtime > CACHE_LOCK_STALE_SECONDS;
+}
+
+// Breaks a lock left behind by a crashed process. Breakers are serialized by
+// a second lock and re-check staleness while holding it, so a waiter that saw
+// the old lock can never remove a fresh one taken in the meantime.
+void breakStaleCacheLock() {
+    if (makeDir(CACHE_BREAK_LOCK) != 0) {
+        // The break lock is only held for a stat and a rmdir
+        if (isStaleLock(CACHE_BREAK_LOCK)) removeDir(CACHE_BREAK_LOCK);
+        return;
+    }
+    if (isStaleLock(CACHE_LOCK)) removeDir(CACHE_LOCK);
+    removeDir(CACHE_BREAK_LOCK);
+}
+
+bool acquireCacheLock() {
+    for (int attempt = 0; attempt < CACHE_LOCK_RETRIES; attempt++) {
+        if (makeDir(CACHE_LOCK) == 0) return true;
+        
+        if (isStaleLock(CACHE_LOCK)) {
+            breakStaleCacheLock();
+            continue;
+        }
+        sleepMs(10);
+    }
+    return false;
+}
+
+void releaseCacheLock() {
+    removeDir(CACHE_LOCK);
+}
+
+int readCacheIndex(CacheEntry entries[CACHE_MAX_ENTRIES + 1]) {
+    FILE* fp = fopen(CACHE_INDEX, "r");
+    if (!fp) return 0;
+    
+    char line[MAX_LINE];
+    int count = 0;
+    fgets(line, MAX_LINE, fp); // Skip header
+    
+    while (fgets(line, MAX_LINE, fp) && count < CACHE_MAX_ENTRIES) {
+        char* token = strtok(line, ",");
+        if (!token || strlen(token) != CACHE_KEY_LEN - 1) continue;
+        strcpy(entries[count].key, token);
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        entries[count].lastUsed = atol(token);
+        count++;
+    }
+    fclose(fp);
+    return count;
+}
+
+bool writeCacheIndex(CacheEntry entries[], int count) {
+    char tmpPath[MAX_LINE];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", CACHE_INDEX, (int)processId());
+    
+    FILE* fp = fopen(tmpPath, "w");
+    if (!fp) return false;
+    fprintf(fp, "Key,LastUsed\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(fp, "%s,%ld\n", entries[i].key, entries[i].lastUsed);
+    }
+    fclose(fp);
+    
+    if (!replaceFile(tmpPath, CACHE_INDEX)) {
+        remove(tmpPath);
+        return false;
+    }
+    return true;
+}
+
+// Marks key as most recently used, inserting it if needed, and evicts the
+// least recently used entries beyond CACHE_MAX_ENTRIES. Caller holds the lock.
+bool updateCacheIndex(const char* key) {
+    CacheEntry entries[CACHE_MAX_ENTRIES + 1];
+    int count = readCacheIndex(entries);
+    long tick = 0;
+    int found = -1;
+    for (int i = 0; i < count; i++) {
+        if (entries[i].lastUsed > tick) tick = entries[i].lastUsed;
+        if (strcmp(entries[i].key, key) == 0) found = i;
+    }
+    
+    if (found == -1) {
+        found = count++;
+        strcpy(entries[found].key, key);
+    }
+    entries[found].lastUsed = tick + 1;
+    
+    while (count > CACHE_MAX_ENTRIES) {
+        int oldest = 0;
+        for (int i = 1; i < count; i++) {
+            if (entries[i].lastUsed < entries[oldest].lastUsed) oldest = i;
+        }
+        char path[MAX_LINE];
+        cacheEntryPath(path, sizeof(path), entries[oldest].key);
+        remove(path);
+        entries[oldest] = entries[--count];
+    }
+    
+    return writeCacheIndex(entries, count);
+}
+
+void touchCacheEntry(const char* key) {
+    if (!acquireCacheLock()) {
+        printf("Warning: Cache index is locked, skipping LRU update\n");
+        return;
+    }
+    updateCacheIndex(key);
+    releaseCacheLock();
+}
+
+// Loads a cached grid. Sections are stored by name and mapped onto the
+// current branch; cells that no longer fit the current slots are dropped.
+bool readCacheEntry(const char* key, TimeSlot grid[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS]) {
+    char path[MAX_LINE];
+    cacheEntryPath(path, sizeof(path), key);
+    FILE* fp = fopen(path, "r");
+    if (!fp) return false;
+    
+    for (int d = 0; d < MAX_DAYS; d++) {
+        for (int p = 0; p < MAX_PERIODS; p++) {
+            for (int s = 0; s < MAX_SECTIONS; s++) {
+                grid[d][p][s].facultyId = -1;
+                grid[d][p][s].subjectId = -1;
+                strcpy(grid[d][p][s].section, "");
+            }
+        }
+    }
+    
+    char line[MAX_LINE];
+    fgets(line, MAX_LINE, fp); // Skip header
+    
+    while (fgets(line, MAX_LINE, fp)) {
+        line[strcspn(line, "\r\n")] = 0;
+        char* token = strtok(line, ",");
+        if (!token) continue;
+        int d = atoi(token) - 1;
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        int p = atoi(token) - 1;
+        char* section = strtok(NULL, ",");
+        if (!section) continue;
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        int subjectId = atoi(token);
+        token = strtok(NULL, ",");
+        if (!token) continue;
+        int facultyId = atoi(token);
+        
+        int s = getSectionIndex(section);
+        if (s == -1 || d < 0 || d >= dayCount || p < 0 || p >= days[d].periods) continue;
+        grid[d][p][s].facultyId = facultyId;
+        grid[d][p][s].subjectId = subjectId;
+        strcpy(grid[d][p][s].section, branch.sections[s]);
+    }
+    fclose(fp);
+    return true;
+}
+
+void storeCacheEntry(const char* key) {
+    char path[MAX_NAME], tmpPath[MAX_LINE];
+    cacheEntryPath(path, sizeof(path), key);
+    snprintf(tmpPath, sizeof(tmpPath), "%s.%d.tmp", path, (int)processId());
+    
+    FILE* fp = fopen(tmpPath, "w");
+    if (!fp) {
+        printf("Warning: Cannot write cache entry %s\n", path);
+        return;
+    }
+    fprintf(fp, "Day,Period,Section,SubjectID,FacultyID\n");
+    for (int d = 0; d < dayCount; d++) {
+        for (int p = 0; p < days[d].periods; p++) {
+            for (int s = 0; s < branch.sectionCount; s++) {
+                if (timetable[d][p][s].facultyId == -1) continue;
+                fprintf(fp, "%d,%d,%s,%d,%d\n", d+1, p+1, branch.sections[s],
+                        timetable[d][p][s].subjectId, timetable[d][p][s].facultyId);
+            }
+        }
+    }
+    fclose(fp);
+    
+    // Publish and index under the lock so every entry on disk is in the
+    // index and therefore subject to LRU eviction
+    if (!acquireCacheLock()) {
+        remove(tmpPath);
+        printf("Warning: Cache index is locked, solution not cached\n");
+        return;
+    }
+    if (!replaceFile(tmpPath, path)) {
+        remove(tmpPath);
+        releaseCacheLock();
+        printf("Warning: Cannot write cache entry %s\n", path);
+        return;
+    }
+    if (!updateCacheIndex(key)) {
+        remove(path);
+        releaseCacheLock();
+        printf("Warning: Cannot update %s, solution not cached\n", CACHE_INDEX);
+        return;
+    }
+    releaseCacheLock();
+    printf("Stored solution in cache (%s)\n", key);
+}
+
+// Number of cached placements whose subject/section/faculty mapping still
+// holds in the current model
+int scoreCachedGrid(TimeSlot grid[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS]) {
+    int score = 0;
+    for (int d = 0; d < dayCount; d++) {
+        for (int p = 0; p < days[d].periods; p++) {
+            for (int s = 0; s < branch.sectionCount; s++) {
+                if (grid[d][p][s].subjectId != -1 &&
+                    getFacultyForSection(grid[d][p][s].subjectId, branch.sections[s]) == grid[d][p][s].facultyId) {
+                    score++;
+                }
+            }
+        }
+    }
+    return score;
+}
+
+// Restores an exact match into the timetable. Returns false on a miss.
+bool loadCachedSolution(const char* key) {
+    if (!readCacheEntry(key, cachedGrid)) return false;
+    
+    clearTimetable();
+    for (int f = 0; f < facultyCount; f++) faculties[f].assignedHours = 0;
+    for (int d = 0; d < dayCount; d++) {
+        for (int p = 0; p < days[d].periods; p++) {
+            for (int s = 0; s < branch.sectionCount; s++) {
+                int facIdx = getFacultyIndex(cachedGrid[d][p][s].facultyId);
+                int subIdx = getSubjectIndex(cachedGrid[d][p][s].subjectId);
+                if (facIdx == -1 || subIdx == -1) continue;
+                placeSlot(d, p, s, facIdx, subIdx);
+                faculties[facIdx].assignedHours++;
+            }
+        }
+    }
+    touchCacheEntry(key);
+    return true;
+}
+
+// Finds the cached solution with the most reusable placements, or NULL
+TimeSlot (*findClosestCachedSolution(void))[MAX_PERIODS][MAX_SECTIONS] {
+    CacheEntry entries[CACHE_MAX_ENTRIES + 1];
+    int count = readCacheIndex(entries);
+    int bestScore = 0;
+    long bestUsed = -1;
+    
+    for (int i = 0; i < count; i++) {
+        if (!readCacheEntry(entries[i].key, cachedGrid)) continue;
+        int score = scoreCachedGrid(cachedGrid);
+        if (score > bestScore || (score == bestScore && score > 0 && entries[i].lastUsed > bestUsed)) {
+            bestScore = score;
+            bestUsed = entries[i].lastUsed;
+            memcpy(closestGrid, cachedGrid, sizeof(closestGrid));
+        }
+    }
+    
+    if (bestScore == 0) return NULL;
+    printf("Closest cached solution shares %d placements\n", bestScore);
+    return closestGrid;
+}
+
+// ============================================================================
+// Timetable Verifier
+// Loads section_timetable.csv back into the grid, cross-checks it against
+// faculty_timetable.csv and checks every hard rule in one pass over the grid.
+// Faculty occupancy is tracked as one bitset per faculty per day.
+// Exit codes: 0 = valid, 1 = violations found, 2 = input error
+// ============================================================================
+#define VERIFY_OK 0
+#define VERIFY_VIOLATIONS 1
+#define VERIFY_INPUT_ERROR 2
+
+FILE* violationOut = NULL;
+int violationCount = 0;
+
+// Writes a double-quoted CSV field, doubling any embedded quotes
+void writeCSVQuoted(FILE* fp, const char* text) {
+    fputc('"', fp);
+    for (; *text; text++) {
+        if (*text == '"') fputc('"', fp);
+        fputc(*text, fp);
+    }
+    fputc('"', fp);
+}
+
+// Writes one row to the violation list: Rule,Section,Day,Period,SubjectID,FacultyID,Detail
+// Pass -1 for any field that does not apply.
+void reportViolation(const char* rule, int sectionIdx, int day, int period,
+                     int subjectId, int facultyId, const char* detail) {
+    violationCount++;
+    if (!violationOut) return;
+    
+    fprintf(violationOut, "%s,", rule);
+    if (sectionIdx >= 0) writeCSVQuoted(violationOut, branch.sections[sectionIdx]);
+    fprintf(violationOut, ",");
+    if (day >= 0) fprintf(violationOut, "%d", day + 1);
+    fprintf(violationOut, ",");
+    if (period >= 0) fprintf(violationOut, "%d", period + 1);
+    fprintf(violationOut, ",");
+    if (subjectId >= 0) fprintf(violationOut, "%d", subjectId);
+    fprintf(violationOut, ",");
+    if (facultyId >= 0) fprintf(violationOut, "%d", facultyId);
+    fprintf(violationOut, ",");
+    writeCSVQuoted(violationOut, detail);
+    fprintf(violationOut, "\n");
+}
+
+int findSubjectByName(const char* name) {
+    for (int i = 0; i < subjectCount; i++) {
+        if (strcmp(subjects[i].name, name) == 0) return subjects[i].id;
+    }
+    return -1;
+}
+
+#define FACULTY_AMBIGUOUS -2
+
+// Faculty names need not be unique. When several share a name, the one mapped
+// to the subject in this section wins; otherwise the name is ambiguous.
+int findFacultyByName(const char* name, int subjectId, int sectionIdx) {
+    int mapped = (subjectId != -1 && sectionIdx != -1) ? getFacultyForSection(subjectId, branch.sections[sectionIdx]) : -1;
+    int found = -1, matches = 0;
+    
+    for (int i = 0; i < facultyCount; i++) {
+        if (strcmp(faculties[i].name, name) != 0) continue;
+        if (faculties[i].id == mapped) return mapped;
+        if (found == -1) found = faculties[i].id;
+        matches++;
+    }
+    return matches > 1 ? FACULTY_AMBIGUOUS : found;
+}
+
+// Splits a CSV line in place. Double-quoted fields have their quotes removed.
+int splitCSVLine(char* line, char* fields[], int maxFields) {
+    int count = 0;
+    char* p = line;
+    
+    while (count < maxFields) {
+        if (*p == '"') {
+            p++;
+            fields[count++] = p;
+            while (*p && *p != '"') p++;
+            if (*p == '"') *p++ = 0;
+            while (*p && *p != ',') p++;
+        } else {
+            fields[count++] = p;
+            while (*p && *p != ',') p++;
+        }
+        if (*p != ',') break;
+        *p++ = 0;
+    }
+    return count;
+}
+
+// Strips the UTF-8 byte order mark spreadsheet tools put on the first line
+void skipBOM(char* line) {
+    if ((unsigned char)line[0] == 0xEF && (unsigned char)line[1] == 0xBB && (unsigned char)line[2] == 0xBF) {
+        memmove(line, line + 3, strlen(line + 3) + 1);
+    }
+}
+
+// Parses a grid cell "Subject (Faculty)" or "Subject LAB (Faculty)".
+// Returns false if the cell is malformed; unknown names come back as -1 and
+// a faculty name that cannot be told apart as FACULTY_AMBIGUOUS.
+bool parseSectionCell(char* cell, int sectionIdx, int* subjectId, int* facultyId) {
+    char* open = strrchr(cell, '(');
+    char* close = strrchr(cell, ')');
+    if (!open || !close || close < open) return false;
+    
+    *open = 0;
+    *close = 0;
+    char* facName = open + 1;
+    trim(facName);
+    trim(cell);
+    
+    *subjectId = findSubjectByName(cell);
+    size_t len = strlen(cell);
+    if (*subjectId == -1 && len > 4 && strcmp(cell + len - 4, " LAB") == 0) {
+        cell[len - 4] = 0;
+        trim(cell);
+        *subjectId = findSubjectByName(cell);
+    }
+    *facultyId = findFacultyByName(facName, *subjectId, sectionIdx);
+    return true;
+}
+
+bool loadSectionTimetableCSV(const char* filename) {
+    FILE* fp = fopen(filename, "r");
+    if (!fp) { printf("Error: Cannot open %s\n", filename); return false; }
+    
+    clearTimetable();
+    
+    char line[MAX_ROW_LINE];
+    char* fields[MAX_PERIODS + 2];
+    char detail[MAX_LINE];
+    unsigned int rowSeen[MAX_SECTIONS] = {0};
+    int sectionIdx = -1;
+    bool first = true;
+    
+    while (fgets(line, sizeof(line), fp)) {
+        if (first) { skipBOM(line); first = false; }
+        line[strcspn(line, "\r\n")] = 0;
+        if (strlen(line) == 0) continue;
+        
+        if (strncmp(line, "Section ", 8) == 0) {
+            char* name = line + 8;
+            trim(name);
+            sectionIdx = getSectionIndex(name);
+            if (sectionIdx == -1) {
+                snprintf(detail, sizeof(detail), "Section %.*s is not in sections.csv", MAX_NAME, name);
+                reportViolation("UNKNOWN_SECTION", -1, -1, -1, -1, -1, detail);
+            }
+            continue;
+        }
+        if (strncmp(line, "Day/Period", 10) == 0 || strncmp(line, "Day ", 4) != 0) continue;
+        if (sectionIdx == -1) continue;
+        
+        int fieldCount = splitCSVLine(line, fields, MAX_PERIODS + 2);
+        int d = atoi(fields[0] + 4) - 1;
+        if (d < 0 || d >= dayCount) {
+            snprintf(detail, sizeof(detail), "%s is not in slots.csv", fields[0]);
+            reportViolation("DAY_OUT_OF_RANGE", sectionIdx, -1, -1, -1, -1, detail);
+            continue;
+        }
+        if (rowSeen[sectionIdx] & (1u << d)) {
+            reportViolation("DUPLICATE_ROW", sectionIdx, d, -1, -1, -1, "Day listed more than once for this section");
+            continue;
+        }
+        rowSeen[sectionIdx] |= 1u << d;
+        
+        for (int p = 0; p + 1 < fieldCount; p++) {
+            char* cell = fields[p + 1];
+            trim(cell);
+            if (strlen(cell) == 0 || strcmp(cell, "--") == 0) continue;
+            
+            if (p >= days[d].periods) {
+                reportViolation("SLOT_OUT_OF_RANGE", sectionIdx, d, p, -1, -1, "Class placed beyond the periods of this day");
+                continue;
+            }
+            
+            int subjectId = -1, facultyId = -1;
+            if (!parseSectionCell(cell, sectionIdx, &subjectId, &facultyId)) {
+                reportViolation("BAD_CELL", sectionIdx, d, p, -1, -1, "Expected Subject (Faculty)");
+                continue;
+            }
+            if (subjectId == -1) {
+                reportViolation("UNKNOWN_SUBJECT", sectionIdx, d, p, -1, facultyId, "Subject is not in subjects.csv");
+                continue;
+            }
+            if (facultyId == -1) {
+                reportViolation("UNKNOWN_FACULTY", sectionIdx, d, p, subjectId, -1, "Faculty is not in faculty.csv");
+                continue;
+            }
+            if (facultyId == FACULTY_AMBIGUOUS) {
+                reportViolation("AMBIGUOUS_FACULTY", sectionIdx, d, p, subjectId, -1,
+                                "Several faculty share this name and none is mapped to the subject here");
+                continue;
+            }
+            
+            placeSlot(d, p, sectionIdx, getFacultyIndex(facultyId), getSubjectIndex(subjectId));
+        }
+    }
+    fclose(fp);
+    printf("Loaded solution from %s\n", filename);
+    return true;
+}
+
+// Checks every row of faculty_timetable.csv against the loaded grid and
+// records which cells were listed (one bit per period) for verifyTimetable.
+bool crossCheckFacultyTimetableCSV(const char* filename, unsigned int listed[MAX_SECTIONS][MAX_DAYS]) {
+    FILE* fp = fopen(filename, "r");
+    if (!fp) { printf("Error: Cannot open %s\n", filename); return false; }
+    
+    memset(listed, 0, sizeof(unsigned int) * MAX_SECTIONS * MAX_DAYS);
+    
+    char line[MAX_LINE];
+    char* fields[6];
+    fgets(line, MAX_LINE, fp); // Skip header
+    
+    while (fgets(line, MAX_LINE, fp)) {
+        line[strcspn(line, "\r\n")] = 0;
+        if (strlen(line) == 0) continue;
+        
+        if (splitCSVLine(line, fields, 6) < 5) {
+            reportViolation("BAD_FACULTY_ROW", -1, -1, -1, -1, -1, "Expected Faculty,Day,Period,Subject,Section");
+            continue;
+        }
+        int d = atoi(fields[1]) - 1;
+        int p = atoi(fields[2]) - 1;
+        int subjectId = findSubjectByName(fields[3]);
+        int s = getSectionIndex(fields[4]);
+        int facultyId = findFacultyByName(fields[0], subjectId, s);
+        
+        if (facultyId == FACULTY_AMBIGUOUS) {
+            reportViolation("AMBIGUOUS_FACULTY", s, d, p, subjectId, -1,
+                            "Several faculty share this name and none is mapped to the subject here");
+            continue;
+        }
+        if (facultyId == -1 || subjectId == -1 || s == -1 ||
+            d < 0 || d >= dayCount || p < 0 || p >= days[d].periods) {
+            reportViolation("FACULTY_ROW_MISMATCH", s, -1, -1, subjectId, facultyId,
+                            "Faculty timetable row does not name a valid slot");
+            continue;
+        }
+        if (listed[s][d] & (1u << p)) {
+            reportViolation("DUPLICATE_ROW", s, d, p, subjectId, facultyId, "Slot listed more than once in faculty timetable");
+            continue;
+        }
+        listed[s][d] |= 1u << p;
+        
+        if (timetable[d][p][s].facultyId != facultyId || timetable[d][p][s].subjectId != subjectId) {
+            reportViolation("FACULTY_ROW_MISMATCH", s, d, p, subjectId, facultyId,
+                            "Faculty timetable disagrees with section timetable");
+        }
+    }
+    fclose(fp);
+    return true;
+}
+
+// Single pass over the grid. Runs of the same subject are measured as they are
+// walked, so lab blocks and consecutive repeats need no second look.
+void verifyTimetable(unsigned int listed[MAX_SECTIONS][MAX_DAYS]) {
+    unsigned int facultyBusy[MAX_FACULTY][MAX_DAYS];
+    int facultyHours[MAX_FACULTY];
+    int delivered[MAX_SUBJECTS][MAX_SECTIONS];
+    int labSessions[MAX_SUBJECTS][MAX_SECTIONS];
+    char detail[MAX_LINE];
+    
+    memset(facultyBusy, 0, sizeof(facultyBusy));
+    memset(facultyHours, 0, sizeof(facultyHours));
+    memset(delivered, 0, sizeof(delivered));
+    memset(labSessions, 0, sizeof(labSessions));
+    
+    for (int d = 0; d < dayCount; d++) {
+        for (int s = 0; s < branch.sectionCount; s++) {
+            int labsToday = 0;
+            int p = 0;
+            
+            while (p < days[d].periods) {
+                int subjectId = timetable[d][p][s].subjectId;
+                if (subjectId == -1) { p++; continue; }
+                
+                int runEnd = p + 1;
+                while (runEnd < days[d].periods && timetable[d][runEnd][s].subjectId == subjectId) runEnd++;
+                
+                int subIdx = getSubjectIndex(subjectId);
+                int mappedFaculty = getFacultyForSection(subjectId, branch.sections[s]);
+                
+                for (int q = p; q < runEnd; q++) {
+                    int facultyId = timetable[d][q][s].facultyId;
+                    unsigned int bit = 1u << q;
+                    
+                    if (listed && !(listed[s][d] & bit)) {
+                        reportViolation("FACULTY_ROW_MISSING", s, d, q, subjectId, facultyId,
+                                        "Class missing from faculty timetable");
+                    }
+                    if (mappedFaculty == -1) {
+                        reportViolation("UNMAPPED_SUBJECT", s, d, q, subjectId, facultyId,
+                                        "Subject has no faculty mapped for this section");
+                    } else if (mappedFaculty != facultyId) {
+                        snprintf(detail, sizeof(detail), "Section is mapped to faculty %d", mappedFaculty);
+                        reportViolation("WRONG_FACULTY", s, d, q, subjectId, facultyId, detail);
+                    }
+                    
+                    int facIdx = getFacultyIndex(facultyId);
+                    if (facIdx == -1) continue;
+                    if (facultyBusy[facIdx][d] & bit) {
+                        int other = 0;
+                        while (other < s && timetable[d][q][other].facultyId != facultyId) other++;
+                        snprintf(detail, sizeof(detail), "Faculty also teaching section %s", branch.sections[other]);
+                        reportViolation("FACULTY_CLASH", s, d, q, subjectId, facultyId, detail);
+                    }
+                    facultyBusy[facIdx][d] |= bit;
+                    facultyHours[facIdx]++;
+                    if (subIdx != -1) delivered[subIdx][s]++;
+                }
+                
+                int runLen = runEnd - p;
+                if (runLen == 2 && subIdx != -1 && subjects[subIdx].isLab) {
+                    labsToday++;
+                    labSessions[subIdx][s]++;
+                } else if (runLen > 1) {
+                    snprintf(detail, sizeof(detail), "Same subject in %d consecutive periods", runLen);
+                    reportViolation("CONSECUTIVE_SUBJECT", s, d, p, subjectId, -1, detail);
+                }
+                p = runEnd;
+            }
+            
+            if (labsToday > 1) {
+                snprintf(detail, sizeof(detail), "%d labs on one day", labsToday);
+                reportViolation("MULTIPLE_LABS", s, d, -1, -1, -1, detail);
+            }
+        }
+    }
+    
+    for (int f = 0; f < facultyCount; f++) {
+        if (facultyHours[f] > faculties[f].maxHours) {
+            snprintf(detail, sizeof(detail), "Assigned %d hours, max %d", facultyHours[f], faculties[f].maxHours);
+            reportViolation("MAX_HOURS_EXCEEDED", -1, -1, -1, -1, faculties[f].id, detail);
+        }
+    }
+    
+    for (int i = 0; i < subjectCount; i++) {
+        for (int j = 0; j < subjects[i].sectionCount; j++) {
+            int s = getSectionIndex(subjects[i].sections[j]);
+            if (s == -1) continue;
+            
+            if (delivered[i][s] != subjects[i].hoursPerWeek) {
+                snprintf(detail, sizeof(detail), "Delivered %d hours, expected %d", delivered[i][s], subjects[i].hoursPerWeek);
+                reportViolation("HOURS_MISMATCH", s, -1, -1, subjects[i].id, subjects[i].facultyIds[j], detail);
+            }
+            if (subjects[i].isLab && labSessions[i][s] == 0) {
+                reportViolation("MISSING_LAB", s, -1, -1, subjects[i].id, subjects[i].facultyIds[j], "No 2-period lab block scheduled");
+            }
+        }
+    }
+}
+
+// Number of hard-rule violations in the current grid, without writing a list
+int countTimetableViolations() {
+    FILE* out = violationOut;
+    violationOut = NULL;
+    violationCount = 0;
+    verifyTimetable(NULL);
+    violationOut = out;
+    return violationCount;
+}
+
+// Warm solve from the closest cached solution. If the result breaks any rule,
+// a cold solve is run as well and the warm grid is only kept when it has no
+// more violations than the cold one, so a warm start is never worse.
+void solveWithWarmStart() {
+    TimeSlot (*closest)[MAX_PERIODS][MAX_SECTIONS] = findClosestCachedSolution();
+    generateTimetable(closest);
+    if (closest == NULL) return;
+    int warmViolations = countTimetableViolations();
+    if (warmViolations == 0) return;
+    
+    static TimeSlot warmGrid[MAX_DAYS][MAX_PERIODS][MAX_SECTIONS];
+    int warmHours[MAX_FACULTY];
+    memcpy(warmGrid, timetable, sizeof(warmGrid));
+    for (int f = 0; f < facultyCount; f++) warmHours[f] = faculties[f].assignedHours;
+    
+    printf("\n=== Warm start has %d violation(s), comparing with a cold solve ===\n", warmViolations);
+    generateTimetable(NULL);
+    int coldViolations = countTimetableViolations();
+    if (coldViolations < warmViolations) {
+        printf("Keeping cold solve (%d vs %d violations)\n", coldViolations, warmViolations);
+        return;
+    }
+    
+    printf("Keeping warm solve (%d vs %d violations)\n", warmViolations, coldViolations);
+    memcpy(timetable, warmGrid, sizeof(timetable));
+    for (int f = 0; f < facultyCount; f++) faculties[f].assignedHours = warmHours[f];
+}
+
+int runVerifier(const char* sectionFile, const char* facultyFile, const char* violationsFile) {
+    printf("=== Timetable Verifier ===\n\n");
+    
+    readFacultyCSV("faculty.csv");
+    readSubjectsCSV("subjects.csv");
+    readSectionsCSV("sections.csv");
+    readSlotsCSV("slots.csv");
+    if (facultyCount == 0 || subjectCount == 0 || branch.sectionCount == 0 || dayCount == 0) {
+        printf("Error: Model CSVs are missing or empty\n");
+        return VERIFY_INPUT_ERROR;
+    }
+    
+    violationOut = fopen(violationsFile, "w");
+    if (!violationOut) {
+        printf("Error: Cannot create %s\n", violationsFile);
+        return VERIFY_INPUT_ERROR;
+    }
+    fprintf(violationOut, "Rule,Section,Day,Period,SubjectID,FacultyID,Detail\n");
+    
+    unsigned int listed[MAX_SECTIONS][MAX_DAYS];
+    if (!loadSectionTimetableCSV(sectionFile) || !crossCheckFacultyTimetableCSV(facultyFile, listed)) {
+        fclose(violationOut);
+        return VERIFY_INPUT_ERROR;
+    }
+    verifyTimetable(listed);
+    fclose(violationOut);
+    
+    printf("\n%d violation(s) written to %s\n", violationCount, violationsFile);
+    return violationCount > 0 ? VERIFY_VIOLATIONS : VERIFY_OK;
+}
+
+// ============================================================================
+// Streaming Export
+// Walks a solved grid once and writes JSON Lines (timetable.jsonl) or one
+// iCalendar file per faculty/section (ics/). Every output goes through a
+// fixed-size ExportStream buffer, so memory does not grow with output size.
+// Labs are exported as a single session spanning their periods.
+// ============================================================================
+#define EXPORT_BUFFER_SIZE 4096
+#define EXPORT_JSONL_FILE "timetable.jsonl"
+#define ICS_DIR "ics"
+#define ICS_DAY_START_MINUTES (9 * 60)  // Period 1 starts at 09:00
+#define ICS_PERIOD_MINUTES 60
+#define ICS_LINE_OCTETS 75
+
+typedef struct {
+    FILE* fp;
+    size_t len;
+    bool failed;    // A write or close failed; the file is incomplete
+    char buf[EXPORT_BUFFER_SIZE];
+} ExportStream;
+
+typedef struct {
+    int day;
+    int period;
+    int length;
+    int sectionIdx;
+    int subIdx;
+    int facIdx;
+    bool isLab;
+} ClassSession;
+
+ExportStream jsonStream;
+ExportStream facultyStreams[MAX_FACULTY];
+ExportStream sectionStreams[MAX_SECTIONS];
+
+bool openStream(ExportStream* out, const char* path) {
+    out->fp = fopen(path, "wb");
+    if (!out->fp) { printf("Error: Cannot create %s\n", path); return false; }
+    setvbuf(out->fp, NULL, _IONBF, 0);  // ExportStream already buffers
+    out->len = 0;
+    out->failed = false;
+    return true;
+}
+
+void flushStream(ExportStream* out) {
+    if (out->len > 0 && fwrite(out->buf, 1, out->len, out->fp) != out->len) out->failed = true;
+    out->len = 0;
+}
+
+// Returns false if anything written to the stream was lost
+bool closeStream(ExportStream* out) {
+    if (!out->fp) return true;
+    flushStream(out);
+    if (fclose(out->fp) != 0) out->failed = true;
+    out->fp = NULL;
+    return !out->failed;
+}
+
+void streamWrite(ExportStream* out, const char* data, size_t n) {
+    while (n > 0) {
+        size_t chunk = EXPORT_BUFFER_SIZE - out->len;
+        if (chunk > n) chunk = n;
+        memcpy(out->buf + out->len, data, chunk);
+        out->len += chunk;
+        data += chunk;
+        n -= chunk;
+        if (out->len == EXPORT_BUFFER_SIZE) flushStream(out);
+    }
+}
+
+void streamPrintf(ExportStream* out, const char* fmt, ...) {
+    char line[MAX_LINE];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (n < 0) return;
+    streamWrite(out, line, (size_t)n < sizeof(line) ? (size_t)n : sizeof(line) - 1);
+}
+
+void streamJSONString(ExportStream* out, const char* text) {
+    streamWrite(out, "\"", 1);
+    for (; *text; text++) {
+        unsigned char c = (unsigned char)*text;
+        if (c == '"' || c == '\\') {
+            char esc[2] = { '\\', (char)c };
+            streamWrite(out, esc, 2);
+        } else if (c < 0x20) {
+            streamPrintf(out, "\\u%04x", c);
+        } else {
+            streamWrite(out, (const char*)&c, 1);
+        }
+    }
+    streamWrite(out, "\"", 1);
+}
+
+// Escapes an iCalendar TEXT value (RFC 5545 section 3.3.11)
+void icsEscape(char* dst, size_t size, const char* src) {
+    size_t n = 0;
+    for (; *src && n + 2 < size; src++) {
+        if (*src == '\\' || *src == ';' || *src == ',') dst[n++] = '\\';
+        dst[n++] = *src;
+    }
+    dst[n] = 0;
+}
+
+// Writes one content line, folded at 75 octets without splitting UTF-8 sequences
+void streamICSLine(ExportStream* out, const char* line) {
+    size_t len = strlen(line);
+    size_t start = 0, limit = ICS_LINE_OCTETS;
+    
+    while (len - start > limit) {
+        size_t cut = start + limit;
+        while (cut > start && ((unsigned char)line[cut] & 0xC0) == 0x80) cut--;
+        streamWrite(out, line + start, cut - start);
+        streamWrite(out, "\r\n ", 3);
+        start = cut;
+        limit = ICS_LINE_OCTETS - 1;  // Continuation lines start with a space
+    }
+    streamWrite(out, line + start, len - start);
+    streamWrite(out, "\r\n", 2);
+}
+
+void writeJSONSession(ExportStream* out, const ClassSession* c) {
+    streamPrintf(out, "{\"section\":");
+    streamJSONString(out, branch.sections[c->sectionIdx]);
+    streamPrintf(out, ",\"day\":%d,\"period\":%d,\"periods\":%d,\"type\":\"%s\",\"subjectId\":%d,\"subject\":",
+                 c->day + 1, c->period + 1, c->length, c->isLab ? "Lab" : "Theory", subjects[c->subIdx].id);
+    streamJSONString(out, subjects[c->subIdx].name);
+    streamPrintf(out, ",\"facultyId\":%d,\"faculty\":", faculties[c->facIdx].id);
+    streamJSONString(out, faculties[c->facIdx].name);
+    streamWrite(out, "}\n", 2);
+}
+
+void writeICSHeader(ExportStream* out, const char* calendarName) {
+    char line[MAX_LINE], text[MAX_LINE / 2];
+    streamICSLine(out, "BEGIN:VCALENDAR");
+    streamICSLine(out, "VERSION:2.0");
+    streamICSLine(out, "PRODID:-//ClassSync//Timetable//EN");
+    streamICSLine(out, "CALSCALE:GREGORIAN");
+    icsEscape(text, sizeof(text), calendarName);
+    snprintf(line, sizeof(line), "X-WR-CALNAME:%s", text);
+    streamICSLine(out, line);
+}
+
+// Weekly recurring event; the first day row of slots.csv falls on weekStart
+void writeICSEvent(ExportStream* out, const ClassSession* c, struct tm weekStart, const char* stamp) {
+    char line[MAX_LINE], text[MAX_LINE / 2], desc[MAX_LINE / 2];
+    
+    struct tm date = weekStart;
+    date.tm_mday += c->day;
+    date.tm_isdst = -1;
+    mktime(&date);
+    
+    int startMin = ICS_DAY_START_MINUTES + c->period * ICS_PERIOD_MINUTES;
+    int endMin = startMin + c->length * ICS_PERIOD_MINUTES;
+    
+    streamICSLine(out, "BEGIN:VEVENT");
+    snprintf(line, sizeof(line), "UID:%s-%d-%d-%d@classsync", branch.sections[c->sectionIdx],
+             c->day + 1, c->period + 1, subjects[c->subIdx].id);
+    streamICSLine(out, line);
+    snprintf(line, sizeof(line), "DTSTAMP:%s", stamp);
+    streamICSLine(out, line);
+    snprintf(line, sizeof(line), "DTSTART:%04d%02d%02dT%02d%02d00", date.tm_year + 1900, date.tm_mon + 1,
+             date.tm_mday, startMin / 60, startMin % 60);
+    streamICSLine(out, line);
+    snprintf(line, sizeof(line), "DTEND:%04d%02d%02dT%02d%02d00", date.tm_year + 1900, date.tm_mon + 1,
+             date.tm_mday, endMin / 60, endMin % 60);
+    streamICSLine(out, line);
+    streamICSLine(out, "RRULE:FREQ=WEEKLY");
+    
+    icsEscape(text, sizeof(text), subjects[c->subIdx].name);
+    snprintf(line, sizeof(line), "SUMMARY:%s%s", text, c->isLab ? " LAB" : "");
+    streamICSLine(out, line);
+    
+    snprintf(desc, sizeof(desc), "Section %s, %s", branch.sections[c->sectionIdx], faculties[c->facIdx].name);
+    icsEscape(text, sizeof(text), desc);
+    snprintf(line, sizeof(line), "DESCRIPTION:%s", text);
+    streamICSLine(out, line);
+    streamICSLine(out, "END:VEVENT");
+}
+
+// Parses YYYY-MM-DD, or uses the current date, and moves back to that week's Monday
+bool resolveWeekStart(const char* startDate, struct tm* weekStart) {
+    time_t now = time(NULL);
+    *weekStart = *localtime(&now);
+    int y = 0, m = 0, d = 0;
+    if (startDate != NULL) {
+        int end = 0;
+        if (sscanf(startDate, "%d-%d-%d%n", &y, &m, &d, &end) != 3 || startDate[end] != 0) return false;
+        weekStart->tm_year = y - 1900;
+        weekStart->tm_mon = m - 1;
+        weekStart->tm_mday = d;
+    }
+    weekStart->tm_hour = 12;
+    weekStart->tm_min = 0;
+    weekStart->tm_sec = 0;
+    weekStart->tm_isdst = -1;
+    if (mktime(weekStart) == (time_t)-1) return false;
+    
+    // mktime normalises out-of-range fields, so 2026-02-30 or month 13 show
+    // up as a different date here
+    if (startDate != NULL && (weekStart->tm_year != y - 1900 ||
+                              weekStart->tm_mon != m - 1 || weekStart->tm_mday != d)) {
+        return false;
+    }
+    
+    weekStart->tm_mday -= (weekStart->tm_wday + 6) % 7;
+    weekStart->tm_isdst = -1;
+    mktime(weekStart);
+    return true;
+}
+
+// Copies a section name into something safe to use as a file name. Any
+// character other than letters, digits, '-' and '_' becomes '_'; if that
+// changed the name, the section number is appended to keep names distinct.
+void safeSectionFileName(char* dst, size_t size, int sectionIdx) {
+    const char* src = branch.sections[sectionIdx];
+    bool changed = false;
+    size_t n = 0;
+    for (; *src && n + 1 < size; src++) {
+        char c = *src;
+        bool ok = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '_';
+        dst[n++] = ok ? c : '_';
+        changed = changed || !ok;
+    }
+    dst[n] = 0;
+    if (changed || n == 0) snprintf(dst + n, size - n, "_%d", sectionIdx + 1);
+}
+
+// Marks ids/names from a list like "101;102" or "A,B". Returns false on an unknown entry.
+bool selectExportTargets(char* list, bool facultyList, bool selected[]) {
+    for (char* token = strtok(list, ",;"); token != NULL; token = strtok(NULL, ",;")) {
+        trim(token);
+        int idx = facultyList ? getFacultyIndex(atoi(token)) : getSectionIndex(token);
+        if (idx == -1) {
+            printf("Error: Unknown %s %s\n", facultyList ? "faculty" : "section", token);
+            return false;
+        }
+        selected[idx] = true;
+    }
+    return true;
+}
+
+// Single pass over the grid. Lab periods of the same subject and faculty are
+// merged into one session, matching how the CSV writers label LAB cells.
+int exportSessions(bool ics, bool facultySelected[], bool sectionSelected[],
+                   struct tm weekStart, const char* stamp) {
+    int exported = 0;
+    
+    for (int d = 0; d < dayCount; d++) {
+        for (int s = 0; s < branch.sectionCount; s++) {
+            int p = 0;
+            while (p < days[d].periods) {
+                TimeSlot* slot = &timetable[d][p][s];
+                ClassSession c = { d, p, 1, s, getSubjectIndex(slot->subjectId), getFacultyIndex(slot->facultyId), false };
+                if (c.subIdx == -1 || c.facIdx == -1) { p++; continue; }
+                
+                if (subjects[c.subIdx].isLab) {
+                    while (p + c.length < days[d].periods &&
+                           timetable[d][p + c.length][s].subjectId == slot->subjectId &&
+                           timetable[d][p + c.length][s].facultyId == slot->facultyId) c.length++;
+                    c.isLab = c.length > 1;
+                }
+                p += c.length;
+                
+                bool toFaculty = facultySelected[c.facIdx];
+                bool toSection = sectionSelected[s];
+                if (!toFaculty && !toSection) continue;
+                
+                if (!ics) {
+                    writeJSONSession(&jsonStream, &c);
+                } else {
+                    if (toFaculty) writeICSEvent(&facultyStreams[c.facIdx], &c, weekStart, stamp);
+                    if (toSection) writeICSEvent(&sectionStreams[s], &c, weekStart, stamp);
+                }
+                exported++;
+            }
+        }
+    }
+    return exported;
+}
+
+// Usage: ClassSync export <jsonl|ics> [--from section_timetable.csv]
+//                  [--faculty 101;102] [--section A;B] [--start YYYY-MM-DD]
+int runExport(int argc, char* argv[]) {
+    if (argc < 3 || (strcmp(argv[2], "jsonl") != 0 && strcmp(argv[2], "ics") != 0)) {
+        printf("Usage: ClassSync export <jsonl|ics> [--from file] [--faculty ids] [--section names] [--start YYYY-MM-DD]\n");
+        return 1;
+    }
+    bool ics = strcmp(argv[2], "ics") == 0;
+    const char* from = "section_timetable.csv";
+    const char* startDate = NULL;
+    char* facultyList = NULL;
+    char* sectionList = NULL;
+    
+    for (int i = 3; i < argc; i += 2) {
+        char* value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--from") == 0) from = value;
+        else if (strcmp(argv[i], "--faculty") == 0) facultyList = value;
+        else if (strcmp(argv[i], "--section") == 0) sectionList = value;
+        else if (strcmp(argv[i], "--start") == 0) startDate = value;
+        else { printf("Error: Unknown option %s\n", argv[i]); return 1; }
+        
+        if (value == NULL) { printf("Error: Option %s needs a value\n", argv[i]); return 1; }
+    }
+    
+    printf("=== Timetable Export ===\n\n");
+    readFacultyCSV("faculty.csv");
+    readSubjectsCSV("subjects.csv");
+    readSectionsCSV("sections.csv");
+    readSlotsCSV("slots.csv");
+    
+    // Faculty are resolved the same way verify does, so a name shared by
+    // several faculty maps to the one assigned to that subject and section.
+    // Cells that still cannot be placed are listed and fail the export, as
+    // they would be missing from every feed.
+    violationOut = stdout;
+    bool loaded = loadSectionTimetableCSV(from);
+    violationOut = NULL;
+    if (!loaded) return 1;
+    if (violationCount > 0) {
+        printf("Error: %d invalid entr%s in %s; run 'ClassSync verify' for details\n",
+               violationCount, violationCount == 1 ? "y" : "ies", from);
+        return 1;
+    }
+    
+    // With no selection everyone is exported
+    bool facultySelected[MAX_FACULTY] = {false};
+    bool sectionSelected[MAX_SECTIONS] = {false};
+    if (facultyList && !selectExportTargets(facultyList, true, facultySelected)) return 1;
+    if (sectionList && !selectExportTargets(sectionList, false, sectionSelected)) return 1;
+    if (!facultyList && !sectionList) {
+        for (int f = 0; f < facultyCount; f++) facultySelected[f] = true;
+        for (int s = 0; s < branch.sectionCount; s++) sectionSelected[s] = true;
+    }
+    
+    struct tm weekStart;
+    if (!resolveWeekStart(startDate, &weekStart)) {
+        printf("Error: Invalid start date %s (expected YYYY-MM-DD)\n", startDate);
+        return 1;
+    }
+    char stamp[32];
+    time_t now = time(NULL);
+    strftime(stamp, sizeof(stamp), "%Y%m%dT%H%M%SZ", gmtime(&now));
+    
+    int files = 0;
+    bool ok = true;
+    char path[MAX_LINE];
+    if (!ics) {
+        ok = openStream(&jsonStream, EXPORT_JSONL_FILE);
+        files = ok ? 1 : 0;
+    } else {
+        makeDir(ICS_DIR);
+        for (int f = 0; f < facultyCount && ok; f++) {
+            if (!facultySelected[f]) continue;
+            snprintf(path, sizeof(path), "%s/faculty_%d.ics", ICS_DIR, faculties[f].id);
+            ok = openStream(&facultyStreams[f], path);
+            if (ok) { writeICSHeader(&facultyStreams[f], faculties[f].name); files++; }
+        }
+        for (int s = 0; s < branch.sectionCount && ok; s++) {
+            if (!sectionSelected[s]) continue;
+            char fileName[MAX_NAME];
+            safeSectionFileName(fileName, sizeof(fileName), s);
+            snprintf(path, sizeof(path), "%s/section_%s.ics", ICS_DIR, fileName);
+            ok = openStream(&sectionStreams[s], path);
+            if (ok) {
+                snprintf(path, sizeof(path), "%s Section %s", branch.branch, branch.sections[s]);
+                writeICSHeader(&sectionStreams[s], path);
+                files++;
+            }
+        }
+    }
+    
+    int exported = ok ? exportSessions(ics, facultySelected, sectionSelected, weekStart, stamp) : 0;
+    
+    bool written = closeStream(&jsonStream);
+    for (int f = 0; f < facultyCount; f++) {
+        if (facultyStreams[f].fp) streamICSLine(&facultyStreams[f], "END:VCALENDAR");
+        written = closeStream(&facultyStreams[f]) && written;
+    }
+    for (int s = 0; s < branch.sectionCount; s++) {
+        if (sectionStreams[s].fp) streamICSLine(&sectionStreams[s], "END:VCALENDAR");
+        written = closeStream(&sectionStreams[s]) && written;
+    }
+    if (!ok) return 1;
+    if (!written) {
+        printf("Error: Write failed, exported files are incomplete\n");
+        return 1;
+    }
+    
+    printf("\nExported %d sessions to %d %s file(s)\n", exported, files, ics ? "iCalendar" : "JSON Lines");
+    return 0;
+}
+
+// Usage: ClassSync [--no-cache]    generate timetable and output files
+//        ClassSync verify [section_timetable.csv] [faculty_timetable.csv] [violations.csv]
+//        ClassSync export <jsonl|ics> [options]
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "export") == 0) {
+        return runExport(argc, argv);
+    }
+    if (argc > 1 && strcmp(argv[1], "verify") == 0) {
+        return runVerifier(argc > 2 ? argv[2] : "section_timetable.csv",
+                           argc > 3 ? argv[3] : "faculty_timetable.csv",
+                           argc > 4 ? argv[4] : "violations.csv");
+    }
+    
+    bool useCache = !(argc > 1 && strcmp(argv[1], "--no-cache") == 0);
+    
+    printf("=== Timetable Generator with Section-Specific Faculty Assignment ===\n\n");
+    
+    readFacultyCSV("faculty.csv");
+    readSubjectsCSV("subjects.csv");
+    readSectionsCSV("sections.csv");
+    readSlotsCSV("slots.csv");
+    
+    printf("\n=== Generating Timetable ===\n");
+    if (!useCache) {
+        generateTimetable(NULL);
+    } else {
+        char key[CACHE_KEY_LEN];
+        computeModelKey(key);
+        makeDir(CACHE_DIR);
+        
+        if (loadCachedSolution(key)) {
+            printf("Cache hit (%s): reusing stored timetable\n", key);
+        } else {
+            printf("Cache miss (%s)\n", key);
+            solveWithWarmStart();
+            storeCacheEntry(key);
+        }
+    }
     
     printf("\n=== Generating Output Files ===\n");
     generateSectionTimetable();